@@ -0,0 +1,127 @@
+#ifndef BOUNDARY_CONDITION_PROGRAM_H
+#define BOUNDARY_CONDITION_PROGRAM_H
+
+#include "GridCollectionOperators.h"
+#include "BoundaryConditionParameters.h"
+
+// =====================================================================================
+//  A list of boundary conditions for a grid function that is registered once and then
+//  applied many times (e.g. every time step):
+//
+//     BoundaryConditionProgram bcProgram;
+//     bcProgram.addBoundaryCondition(V,BCTypes::dirichlet,wall,0.);
+//     bcProgram.addBoundaryCondition(V,BCTypes::extrapolate,wall,0.,extrapParams);
+//     ...
+//     bcProgram.apply(u,t);    // apply all BC's, then fix corners, periodic and ghost boundaries
+//
+//  For each grid the program keeps only the boundary conditions that match at least one
+//  side. This list is rebuilt if the boundaryCondition array of a grid changes. The
+//  conditions are applied grid by grid in the order they were added. The corners and
+//  periodic edges are then fixed with one call to finishBoundaryConditions, which (in
+//  parallel) updates the ghost boundaries of all grids with one exchange.
+//
+//  The BoundaryConditionParameters and forcing grid functions are referenced, not copied,
+//  and must exist as long as the program is used.
+// =====================================================================================
+class BoundaryConditionProgram
+{
+public:
+
+BoundaryConditionProgram();
+~BoundaryConditionProgram();
+
+// add a boundary condition with a constant forcing
+int addBoundaryCondition( const Index & C,
+                          const BCTypes::BCNames & boundaryConditionType,
+                          const int & boundaryCondition=BCTypes::allBoundaries,
+                          const real & forcing=0.,
+                          const BoundaryConditionParameters & bcParameters
+                                     =Overture::defaultBoundaryConditionParameters() );
+
+// add a boundary condition with forcing given by an array (one value per component)
+int addBoundaryCondition( const Index & C,
+                          const BCTypes::BCNames & boundaryConditionType,
+                          const int & boundaryCondition,
+                          const RealArray & forcing,
+                          const BoundaryConditionParameters & bcParameters
+                                     =Overture::defaultBoundaryConditionParameters() );
+
+// add a boundary condition with forcing from a grid function (this is referenced, not copied)
+int addBoundaryCondition( const Index & C,
+                          const BCTypes::BCNames & boundaryConditionType,
+                          const int & boundaryCondition,
+                          const realGridCollectionFunction & forcing,
+                          const BoundaryConditionParameters & bcParameters
+                                     =Overture::defaultBoundaryConditionParameters() );
+
+// apply all boundary conditions (to some grids) and finish the boundary conditions
+int apply( realGridCollectionFunction & u, const real & time=0.,
+           const IntegerArray & gridsToUpdate=Overture::nullIntArray() );
+
+// apply all boundary conditions to a single grid (no finish)
+int apply( realMappedGridFunction & u, const real & time=0., const int & grid=0 );
+
+// parameters (and components) for finishBoundaryConditions
+int setFinishBoundaryConditions( bool trueOrFalse=true,
+                                 const BoundaryConditionParameters & bcParameters
+                                      =Overture::defaultBoundaryConditionParameters(),
+                                 const Range & C=nullRange );
+
+int getNumberOfBoundaryConditions() const;
+
+// remove all boundary conditions
+void clear();
+
+// cpu time spent in apply
+real getTime() const;
+
+static int debug;
+
+protected:
+
+enum ForcingTypeEnum
+{
+  scalarForcing,
+  arrayForcing,
+  gridFunctionForcing
+};
+
+struct Instruction
+{
+  Index C;
+  BCTypes::BCNames bcType;
+  int bc;
+  ForcingTypeEnum forcingType;
+  real scalarData;
+  RealArray arrayData;
+  const realGridCollectionFunction *gfData;
+  const BoundaryConditionParameters *parameters;  // referenced, not copied
+};
+
+// return true if the instruction applies to some side of the grid
+bool appliesToGrid( const Instruction & instruction, MappedGrid & mg ) const;
+
+// build the list of instructions for a grid if needed
+const std::vector<int> & getGridProgram( MappedGrid & mg, const int grid );
+
+void applyInstruction( const Instruction & instruction, realMappedGridFunction & u,
+                       const real & time, const int grid );
+
+std::vector<Instruction*> instructions;
+
+// for each grid: the boundaryCondition values used to build the list and the list itself
+std::vector< std::vector<int> > gridKey, gridProgram;
+
+bool finish;
+const BoundaryConditionParameters *finishParameters;
+Range finishComponents;
+real timeForApply;
+
+private:
+
+BoundaryConditionProgram( const BoundaryConditionProgram & );
+BoundaryConditionProgram & operator=( const BoundaryConditionProgram & );
+
+};
+
+#endif
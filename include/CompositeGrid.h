@@ -164,7 +164,8 @@ class CompositeGridData:
       const Integer&      level,
       const Integer       k = 0);
     // replace refinement level level0 and higher
-    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo );
+    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo,
+                                            bool reuseUnchangedGrids=false );
     virtual void deleteRefinement(const Integer& k);
     virtual void deleteRefinementLevels(const Integer level = 0);
     inline void referenceRefinementLevels(
@@ -596,7 +597,8 @@ class CompositeGrid:
         return addRefinement(range, factors, level, k);
     }
     // replace refinement level level0 and higher
-    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo );
+    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo,
+                                            bool reuseUnchangedGrids=false );
 //
 //  Delete all multigrid levels of refinement grid k.
 //
@@ -145,6 +145,7 @@ protected:
 			   IntegerArray & consistent,
 			   IntegerArray & inconsistent );
   int  findOutwardTangent( Mapping & map, const realArray & r,  const realArray & x, realArray & outwardTangent );
+  int  projectOntoSubSurfaces( realArray & x, MappingProjectionParameters & mpParameters );
   
   IntegerArray visible;  // is a sub surface visible
   IntegerArray surfaceIdentifier;  // user defined identifier for the surface
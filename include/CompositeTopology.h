@@ -94,6 +94,8 @@ getTriangulationSurface(int s) {return (triangulationSurface? triangulationSurfa
  real getDeltaS() const;
  // kkc 
  bool computeTopology(GenericGraphicsInterface & gi, int debug=0);
+ // reuse the triangulations of sub-surfaces that have not changed when the global triangulation is rebuilt
+ void setUseTriangulationCache( bool trueOrFalse=true );
  // kkc
  void invalidateTopology();
 
@@ -183,6 +185,15 @@ buildSubSurfaceTriangulation(int s,
 			     GenericGraphicsInterface & gi,
 			     GraphicsParameters& params);
 
+int
+getSubSurfaceTriangulationKey( int s, int key[2] );
+
+int
+initializeTriangulationCache();
+
+int
+destroyTriangulationCache();
+
 int 
 printEdgeCurveInfo(GenericGraphicsInterface & gi);
 
@@ -202,6 +213,17 @@ UnstructuredMapping *globalTriangulation;
 //! Holds the triangulation when some surfaces are hidden.
 UnstructuredMapping *globalTriangulationForVisibleSurfaces;
   
+//! A cached triangulation of a sub-surface along with the data needed to merge it into the global triangulation.
+struct SubSurfaceTriangulation
+{
+  SubSurfaceTriangulation() : triangulation(NULL), numberOfBoundaryNodes(0) { key[0]=key[1]=0; }
+  int key[2];                      // hash of the edge curves, surface and parameters used to build the triangulation
+  UnstructuredMapping *triangulation;
+  int numberOfBoundaryNodes;
+  realArray rCoordinates;          // parameter space coordinates of the nodes
+  IntegerArray boundaryNodeInfo;   // edge curve information for the boundary nodes
+};
+
 //! An array of pointers to edge curves (which has a pointer to the corresponding CurveSegment object).
 EdgeInfo **allEdges; // pointer array to all boundary and master EdgeInfo's
 int numberOfUniqueEdgeCurves; // number of boundary and master EdgeInfo's
@@ -236,6 +258,11 @@ ArraySimple<real> boundingBox;
   
 //! An array of triangulations for each sub-surface
 UnstructuredMapping **triangulationSurface;
+
+//! Cached sub-surface triangulations (kept by cleanup() and saved with the topology).
+SubSurfaceTriangulation *triangulationCache;
+int triangulationCacheSize;
+bool useTriangulationCache;
   
 //! True if the global triangulation has been built.
 bool triangulationIsValid;
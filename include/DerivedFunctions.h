@@ -85,6 +85,14 @@ class DerivedFunctions
 
   void set( ShowFileReader & showFileReader, GraphicsParameters *pgp=NULL  );
 
+  // Compute the derived items for a grid in one pass that shares the derivative evaluations
+  void setUseBatchedEvaluation( bool trueOrFalse=true );
+  void setNumberOfThreads( int numThreads );  // 0 = use the default number
+
+  // Compute the derived items for a range of frames and save them to a new show file
+  int saveDerivedFunctions( int firstFrame, int lastFrame, int frameStride, 
+                            const aString & nameOfShowFile );
+
   // A user can define new derived functions using these functions 
   int setupUserDefinedDerivedFunction(GenericGraphicsInterface & gi, 
 	  			      int numberOfComponents, 
@@ -108,6 +116,11 @@ class DerivedFunctions
  protected:
 
   int computeDerivedFunctions( realCompositeGridFunction & u );
+  bool getFirstDerivativeComponents( int numberOfComponents, int numberOfDimensions, Range & D );
+  bool evaluateFromFirstDerivatives( int item, int component, int j, realSerialArray & v,
+				     const realSerialArray & ux, const realSerialArray & uy, 
+                                     const realSerialArray & uz, const Range & D,
+				     Index & I1, Index & I2, Index & I3, int numberOfDimensions );
   int getComponent( int & c, const aString & cName );
   void initialize();
 
@@ -124,6 +137,9 @@ class DerivedFunctions
   int displacementComponent[3];  // displacement components
   int stressComponent[9];        // stress components
 
+  bool batchedEvaluation;        // share derivative evaluations between derived items
+  int numberOfThreads;
+
 };
 
 #endif
@@ -77,6 +77,11 @@ class EllipticGridGenerator
 		   const realArray & r0 = Overture::nullRealDistributedArray(),
                    const IntegerArray & indexBounds=Overture::nullIntArray() );
 
+  // supply a new starting grid but keep the interior displacements of the current solution.
+  int restartFromPreviousSolution(const realArray & u0,
+				  const realArray & r0 = Overture::nullRealDistributedArray(),
+				  const IntegerArray & indexBounds=Overture::nullIntArray() );
+
   // Interactively choose parameters and compute elliptic grid.
   int update(DataPointMapping & dpm,
              GenericGraphicsInterface *gi = NULL , 
@@ -153,6 +158,12 @@ class EllipticGridGenerator
   int redBlack(const int & level, 
 	       RealMappedGridFunction & uu );
 
+  int redBlackSweep(const int & level, 
+		    RealMappedGridFunction & uu,
+		    const realArray & coeff,
+		    const Index Kv[3],
+		    const real & omega0 );
+
   void getResidual(realArray &resid1, 
                    const int & level);
 
@@ -251,6 +262,7 @@ class EllipticGridGenerator
   bool useNewStuff;
 
   int debug;
+  int numberOfThreads;          // number of threads for the red-black smoother
 
   TridiagonalSolver *tridiagonalSolver;
   
@@ -2,6 +2,7 @@
 #define EXPOSED_POINTS_H
 
 #include "Overture.h"
+#include <map>
 
 // This class is used to interpolate "exposed" points for moving grid computations.
 
@@ -68,6 +69,28 @@ int setNumberOfValidGhostPoints( int numValidGhost );
 // Choose the interpolation option
 int setInterpolationOption( int option );
 
+// Use the donors found by the previous initialize to start the nearest grid point search of the
+// inverse mapping (old interpolation option)
+void setUseDonorCache( bool trueOrFalse=true );
+
+enum TimingsEnum
+{
+  timeForInitialize=0,
+  timeForInverseMap,               // part of initialize (old interpolation option)
+  timeForBuildInterpolationInfo,   // part of interpolate (new interpolation option)
+  timeForInterpolate,
+  numberOfTimings
+};
+
+// cpu time for the last call (lastCall=true) or the total time for all calls
+real getTime( const TimingsEnum t, const bool lastCall=true ) const;
+
+// number of exposed points given a guess from the donor cache by the last initialize
+int getNumberOfDonorCacheHits() const;
+
+// print timings and donor cache statistics
+int printStatistics( FILE *file=stdout ) const;
+
 static int debug;
 static int info;
 
@@ -105,6 +128,20 @@ RealArray exposedInterpolationCoordinates;
 
 bool fillExposedInterpolationPoints; // kkc 110323
 
+// donor cache: (grid,i1,i2,i3) of exposed points from the previous initialize -> donor grid and
+// unit square coordinates
+int useDonorCache;
+std::map<long long,int> donorCacheIndex;
+IntegerArray donorCacheGrid;
+RealArray donorCacheCoordinates;
+int numberOfDonorCacheHits, numberOfPointsInverted;
+
+real timing[numberOfTimings], lastTiming[numberOfTimings];
+
+void clearDonorCache();
+int getDonorGuesses( const int donorGrid, const int numberOfPoints, const IntegerArray & ip, RealArray & r );
+int saveDonorCache();
+
 static FILE *debugFile;
 
 static int 
@@ -127,7 +164,8 @@ checkForBetterQualityInterpolation( CompositeGrid & cg1, const int gridI, const
 				    IntegerArray & interpoleeLocation,
 				    IntegerArray & interpolationPoint,
 				    IntegerArray & variableInterpolationWidth,
-				    RealArray & interpolationCoordinates );
+				    RealArray & interpolationCoordinates,
+                                    const RealArray *rGuess=NULL );
 
 static int 
 interpolatePoints(const realCompositeGridFunction & u,
@@ -0,0 +1,286 @@
+#ifndef FIXED_STENCIL_H
+#define FIXED_STENCIL_H
+
+// =====================================================================================
+//  A stencil whose size is fixed at compile time:
+//
+//     FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>
+//
+//  The weights are held in a dense array of (2*halfWidth+1)^numberOfDimensions values, so
+//  the loops over the stencil have compile-time bounds. The default halfWidth,
+//  orderOfAccuracy/2, fits the centered first and second derivatives of that order:
+//
+//     FixedStencil<2,4> ux, lap;
+//     ux.setDerivative(axis1,1,dx[0]);      // 4th order d/dx on a rectangular grid
+//     lap.setLaplacian(dx);                 // 4th order Laplacian
+//     ux.applyStencil(u,v,I1,I2,I3,N);      // v(I1,I2,I3,N) = D_x u
+//
+//  applyStencil works line by line on the raw data. The non-zero weights of each line are
+//  added in turn, so the loop along the line vectorizes. With OpenMP (OV_USE_OPENMP) the
+//  lines are divided among the threads. A generic Stencil can be converted to or from a
+//  FixedStencil if it fits.
+//
+//  Only serial arrays are supported (use the local arrays in parallel).
+// =====================================================================================
+
+#include "Stencil.h"
+
+#ifdef OV_USE_OPENMP
+#include <omp.h>
+#endif
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth=orderOfAccuracy/2>
+class FixedStencil
+{
+public:
+
+enum
+{
+  width=2*halfWidth+1,
+  numberOfWeights= numberOfDimensions==1 ? width : numberOfDimensions==2 ? width*width : width*width*width
+};
+
+FixedStencil(){ setToZero(); }
+FixedStencil( const Stencil & stencil ){ setStencil(stencil); }
+
+void setToZero(){ for( int m=0; m<numberOfWeights; m++ ) w[m]=0.; }
+
+// weight for the offset (m1,m2,m3), -halfWidth <= m <= halfWidth
+real & operator()( const int m1, const int m2=0, const int m3=0 ){ return w[index(m1,m2,m3)]; }
+real operator()( const int m1, const int m2=0, const int m3=0 ) const { return w[index(m1,m2,m3)]; }
+
+// centered derivative of order 1 or 2 along an axis with grid spacing h
+int setDerivative( const int axis, const int derivative, const real h );
+
+// centered Laplacian with grid spacings h[0..numberOfDimensions-1]
+int setLaplacian( const real *h );
+
+// copy the weights of a generic Stencil (abort if it does not fit)
+int setStencil( const Stencil & stencil );
+
+// return the non-zero weights as a generic Stencil
+int getStencil( Stencil & stencil ) const;
+
+// v(I1,I2,I3,N) = sum w(m) u(I1+m1,I2+m2,I3+m3,N)
+RealArray & applyStencil( const RealArray & u, RealArray & v,
+                          const Index & I1, const Index & I2, const Index & I3, const Index & N ) const;
+
+protected:
+
+static int index( const int m1, const int m2, const int m3 )
+{
+  return (m1+halfWidth)+width*( (numberOfDimensions>1 ? m2+halfWidth : 0)+
+                                width*(numberOfDimensions>2 ? m3+halfWidth : 0) );
+}
+
+// centered difference weights of the given order of accuracy, c[m+halfWidth], m=-p/2..p/2
+static int getDifferenceWeights( const int derivative, real *c );
+
+real w[numberOfWeights];
+};
+
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth>
+int FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>::
+getDifferenceWeights( const int derivative, real *c )
+{
+  static const real d1[4][9]=
+  {
+    {           0.,       0.,      0.,    -1./2., 0.,   1./2.,      0.,       0.,        0. },
+    {           0.,       0.,  1./12.,    -2./3., 0.,   2./3.,  -1./12.,      0.,        0. },
+    {           0., -1./60.,   3./20.,    -3./4., 0.,   3./4.,  -3./20.,  1./60.,        0. },
+    {  1./280., -4./105.,      1./5.,    -4./5., 0.,   4./5.,   -1./5., 4./105., -1./280. }
+  };
+  static const real d2[4][9]=
+  {
+    {        0.,       0.,      0.,     1.,       -2.,     1.,      0.,       0.,        0. },
+    {        0.,       0., -1./12.,  4./3.,    -5./2.,  4./3., -1./12.,       0.,        0. },
+    {        0.,  1./90.,  -3./20.,  3./2.,  -49./18.,  3./2., -3./20.,  1./90.,         0. },
+    { -1./560., 8./315.,    -1./5.,  8./5., -205./72.,  8./5.,  -1./5., 8./315., -1./560. }
+  };
+  if( orderOfAccuracy<2 || orderOfAccuracy>8 || orderOfAccuracy%2!=0 || derivative<1 || derivative>2 )
+  {
+    printf("FixedStencil:ERROR: centered differences are available for derivative=1,2 and"
+           " orderOfAccuracy=2,4,6,8 (derivative=%i, orderOfAccuracy=%i)\n",derivative,orderOfAccuracy);
+    OV_ABORT("error");
+  }
+  if( halfWidth<orderOfAccuracy/2 )
+  {
+    printf("FixedStencil:ERROR: halfWidth=%i is too small for orderOfAccuracy=%i\n",halfWidth,orderOfAccuracy);
+    OV_ABORT("error");
+  }
+  const real *d = derivative==1 ? d1[orderOfAccuracy/2-1] : d2[orderOfAccuracy/2-1];
+  for( int m=-halfWidth; m<=halfWidth; m++ )
+    c[m+halfWidth] = abs(m)<=4 ? d[m+4] : 0.;
+  return 0;
+}
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth>
+int FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>::
+setDerivative( const int axis, const int derivative, const real h )
+{
+  if( axis<0 || axis>=numberOfDimensions )
+  {
+    printf("FixedStencil::setDerivative:ERROR: axis=%i but numberOfDimensions=%i\n",axis,numberOfDimensions);
+    OV_ABORT("error");
+  }
+  real c[width];
+  getDifferenceWeights(derivative,c);
+  const real scale = derivative==1 ? 1./h : 1./(h*h);
+  setToZero();
+  for( int m=-halfWidth; m<=halfWidth; m++ )
+    w[index(axis==0 ? m : 0, axis==1 ? m : 0, axis==2 ? m : 0)]=c[m+halfWidth]*scale;
+  return 0;
+}
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth>
+int FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>::
+setLaplacian( const real *h )
+{
+  real c[width];
+  getDifferenceWeights(2,c);
+  setToZero();
+  for( int axis=0; axis<numberOfDimensions; axis++ )
+  {
+    const real scale=1./(h[axis]*h[axis]);
+    for( int m=-halfWidth; m<=halfWidth; m++ )
+      w[index(axis==0 ? m : 0, axis==1 ? m : 0, axis==2 ? m : 0)]+=c[m+halfWidth]*scale;
+  }
+  return 0;
+}
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth>
+int FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>::
+setStencil( const Stencil & stencil )
+{
+  setToZero();
+  for( int i=0; i<stencil.getNumberOfWeights(); i++ )
+  {
+    int m[3];
+    for( int axis=0; axis<3; axis++ )
+    {
+      m[axis]=stencil.getOffset(i,axis);
+      if( abs(m[axis])>halfWidth || (axis>=numberOfDimensions && m[axis]!=0) )
+      {
+        printf("FixedStencil::setStencil:ERROR: offset (%i,%i,%i) does not fit in a FixedStencil"
+               " with numberOfDimensions=%i and halfWidth=%i\n",stencil.getOffset(i,0),stencil.getOffset(i,1),
+               stencil.getOffset(i,2),numberOfDimensions,halfWidth);
+        OV_ABORT("error");
+      }
+    }
+    w[index(m[0],m[1],m[2])]+=stencil.getWeight(i);
+  }
+  return 0;
+}
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth>
+int FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>::
+getStencil( Stencil & stencil ) const
+{
+  stencil=Stencil();
+  Point offset(1,3);
+  const int h2 = numberOfDimensions>1 ? halfWidth : 0;
+  const int h3 = numberOfDimensions>2 ? halfWidth : 0;
+  for( int m3=-h3; m3<=h3; m3++ )
+  for( int m2=-h2; m2<=h2; m2++ )
+  for( int m1=-halfWidth; m1<=halfWidth; m1++ )
+  {
+    const real weight=w[index(m1,m2,m3)];
+    if( weight!=0. )
+    {
+      offset(0,0)=m1; offset(0,1)=m2; offset(0,2)=m3;
+      stencil.addWeight(weight,offset);
+    }
+  }
+  return 0;
+}
+
+template<int numberOfDimensions, int orderOfAccuracy, int halfWidth>
+RealArray & FixedStencil<numberOfDimensions,orderOfAccuracy,halfWidth>::
+applyStencil( const RealArray & u, RealArray & v,
+              const Index & I1, const Index & I2, const Index & I3, const Index & N ) const
+{
+  const int i1a=I1.getBase(), i1b=I1.getBound();
+  const int i2a=I2.getBase(), i2b=I2.getBound();
+  const int i3a=I3.getBase(), i3b=I3.getBound();
+  const int na=N.getBase(), nb=N.getBound();
+  if( i1a>i1b || i2a>i2b || i3a>i3b || na>nb )
+    return v;
+
+  if( &u==&v )
+  {
+    printf("FixedStencil::applyStencil:ERROR: u and v must be different arrays\n");
+    OV_ABORT("error");
+  }
+  const int h2 = numberOfDimensions>1 ? halfWidth : 0;
+  const int h3 = numberOfDimensions>2 ? halfWidth : 0;
+  if( i1a-halfWidth<u.getBase(0) || i1b+halfWidth>u.getBound(0) ||
+      i2a-h2<u.getBase(1) || i2b+h2>u.getBound(1) ||
+      i3a-h3<u.getBase(2) || i3b+h3>u.getBound(2) ||
+      i1a<v.getBase(0) || i1b>v.getBound(0) || i2a<v.getBase(1) || i2b>v.getBound(1) ||
+      i3a<v.getBase(2) || i3b>v.getBound(2) ||
+      na<u.getBase(3) || nb>u.getBound(3) || na<v.getBase(3) || nb>v.getBound(3) )
+  {
+    printf("FixedStencil::applyStencil:ERROR: the stencil does not fit in u or v\n");
+    OV_ABORT("error");
+  }
+
+  const real *up = u.Array_Descriptor.Array_View_Pointer3;
+  const int uDim0=u.getRawDataSize(0);
+  const int uDim1=u.getRawDataSize(1);
+  const int uDim2=u.getRawDataSize(2);
+  real *vp = v.Array_Descriptor.Array_View_Pointer3;
+  const int vDim0=v.getRawDataSize(0);
+  const int vDim1=v.getRawDataSize(1);
+  const int vDim2=v.getRawDataSize(2);
+
+  // non-zero weights and their offsets in u
+  real weight[numberOfWeights];
+  int offset[numberOfWeights];
+  int numberOfTerms=0;
+  for( int m3=-h3; m3<=h3; m3++ )
+  for( int m2=-h2; m2<=h2; m2++ )
+  for( int m1=-halfWidth; m1<=halfWidth; m1++ )
+  {
+    const real wm=w[index(m1,m2,m3)];
+    if( wm!=0. )
+    {
+      weight[numberOfTerms]=wm;
+      offset[numberOfTerms]=m1+uDim0*(m2+uDim1*m3);
+      numberOfTerms++;
+    }
+  }
+
+  const int n1=i1b-i1a+1, n2=i2b-i2a+1, n3=i3b-i3a+1;
+  const int numberOfLines=n2*n3*(nb-na+1);
+
+  #ifdef OV_USE_OPENMP
+  #pragma omp parallel for schedule(static)
+  #endif
+  for( int line=0; line<numberOfLines; line++ )
+  {
+    const int i2=i2a+line%n2, i3=i3a+(line/n2)%n3, n=na+line/(n2*n3);
+    const real *uLine = up+i1a+uDim0*(i2+uDim1*(i3+uDim2*n));
+    real *vLine = vp+i1a+vDim0*(i2+vDim1*(i3+vDim2*n));
+    if( numberOfTerms==0 )
+    {
+      for( int i=0; i<n1; i++ )
+        vLine[i]=0.;
+      continue;
+    }
+    const real w0=weight[0];
+    const real *u0=uLine+offset[0];
+    for( int i=0; i<n1; i++ )
+      vLine[i]=w0*u0[i];
+    for( int k=1; k<numberOfTerms; k++ )
+    {
+      const real wk=weight[k];
+      const real *uk=uLine+offset[k];
+      for( int i=0; i<n1; i++ )
+        vLine[i]+=wk*uk[i];
+    }
+  }
+  return v;
+}
+
+#endif
@@ -59,6 +59,12 @@ class FourierOperators
 		 const RealArray & u, 
 		 RealArray & uHat, 
 		 const Range & Components );
+
+  // number of lines transformed together (default 16)
+  void setNumberOfLinesPerBatch( const int numberOfLines );
+
+  // delete the FFT plans shared by all FourierOperators
+  static void clearPlans();
   
 // --- define versions taking distributed arrays ---
 #ifdef USE_PPP
@@ -98,8 +104,10 @@ class FourierOperators
   Range R1,R2,R3;
   bool initialized;
   void initialize();
-  RealArray uTemp;
-  RealArray wsavex,wsavey,wsavez;
+  // FFT plans (work arrays from rffti) for each direction, shared by all objects with the same n
+  const std::vector<real> *planx,*plany,*planz;
+  int numberOfLinesPerBatch, planGeneration;
+  static const std::vector<real> & getPlan( const int n );
   RealArray kSquared,kxDerivative,kyDerivative,kzDerivative;
 };
 
@@ -0,0 +1,316 @@
+#ifndef FUSED_ARRAY_EXPRESSION_H
+#define FUSED_ARRAY_EXPRESSION_H
+
+// =====================================================================================
+//  Fused evaluation of A++ array statements
+//
+//  Write array statements with the FUSED macro, for example
+//
+//     FUSED(u,I1,I2) = a*FUSED(v,I1+1,I2) + b*FUSED(v,I1-1,I2) + c*FUSED(w,I1,I2);
+//
+//  By default FUSED(u,I1,I2) is just u(I1,I2), so A++ evaluates the statement and
+//  creates a temporary for each binary operation. If OV_USE_FUSED_ARRAY_EXPRESSIONS is
+//  defined, the right-hand side becomes an expression template and the statement runs as
+//  a single loop over the index space with no temporaries. Views may have strides.
+//
+//  Notes:
+//   - Only serial arrays are supported (use the local arrays in parallel).
+//   - If the destination overlaps a shifted view on the right-hand side, for example
+//       FUSED(u,I1)=FUSED(u,I1+1), the result is first evaluated into a temporary as in A++.
+//   - Supported: + - * / with arrays and scalars, unary minus, and sqrt, fabs, sin,
+//     cos and exp.
+// =====================================================================================
+
+#include "A++.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef OV_USE_FUSED_ARRAY_EXPRESSIONS
+  #define FUSED(u,...) FusedArray::view(u,__VA_ARGS__)
+#else
+  #define FUSED(u,...) (u)(__VA_ARGS__)
+#endif
+
+namespace FusedArray
+{
+
+const int maxDim=4;
+
+// ---------------------------------------------------------------------------------
+// Expression wrapper: all nodes are wrapped in Expr<> so that the operators below
+// only apply to fused expressions.
+// ---------------------------------------------------------------------------------
+template<class E>
+struct Expr
+{
+  typedef typename E::value_type value_type;
+  E e;
+  Expr( const E & e0 ) : e(e0) {}
+  inline value_type operator()(int i0, int i1, int i2, int i3) const { return e(i0,i1,i2,i3); }
+  inline bool conforms( const int *length ) const { return e.conforms(length); }
+  inline bool overlaps( const void *lo, const void *hi, const void *data, const int *step ) const
+    { return e.overlaps(lo,hi,data,step); }
+};
+
+// a scalar
+template<class T>
+struct Scalar
+{
+  typedef T value_type;
+  T value;
+  Scalar( T v ) : value(v) {}
+  inline T operator()(int, int, int, int) const { return value; }
+  inline bool conforms( const int * ) const { return true; }
+  inline bool overlaps( const void *, const void *, const void *, const int * ) const { return false; }
+};
+
+// a (possibly strided) view of an array:  element (i0,i1,i2,i3) of the view is
+//        data[ i0*step[0] + i1*step[1] + i2*step[2] + i3*step[3] ],   0 <= i_d < length[d]
+template<class T>
+struct ViewNode
+{
+  typedef T value_type;
+  T *data;
+  int step[maxDim], length[maxDim];
+  inline T operator()(int i0, int i1, int i2, int i3) const
+    { return data[i0*step[0]+i1*step[1]+i2*step[2]+i3*step[3]]; }
+  inline bool conforms( const int *len ) const
+  {
+    for( int d=0; d<maxDim; d++ )
+      if( length[d]!=len[d] ) return false;
+    return true;
+  }
+  // memory range of the view
+  inline const T* first() const
+  {
+    const T *p=data;
+    for( int d=0; d<maxDim; d++ ) if( step[d]<0 ) p+=step[d]*(length[d]-1);
+    return p;
+  }
+  inline const T* last() const
+  {
+    const T *p=data;
+    for( int d=0; d<maxDim; d++ ) if( step[d]>0 ) p+=step[d]*(length[d]-1);
+    return p;
+  }
+  // true if this view reads memory written by the destination [lo,hi] at a different location
+  inline bool overlaps( const void *lo, const void *hi, const void *dData, const int *dStep ) const
+  {
+    if( (const void*)last()<lo || (const void*)first()>hi ) return false;
+    if( (const void*)data!=dData ) return true;
+    for( int d=0; d<maxDim; d++ )
+      if( step[d]!=dStep[d] && length[d]>1 ) return true;
+    return false;   // identical view: element by element update is safe
+  }
+};
+
+template<class L, class R, class Op>
+struct Binary
+{
+  typedef typename L::value_type value_type;
+  L l;
+  R r;
+  Binary( const L & l0, const R & r0 ) : l(l0), r(r0) {}
+  inline value_type operator()(int i0, int i1, int i2, int i3) const
+    { return Op::apply(l(i0,i1,i2,i3),r(i0,i1,i2,i3)); }
+  inline bool conforms( const int *length ) const { return l.conforms(length) && r.conforms(length); }
+  inline bool overlaps( const void *lo, const void *hi, const void *data, const int *step ) const
+    { return l.overlaps(lo,hi,data,step) || r.overlaps(lo,hi,data,step); }
+};
+
+template<class A, class Op>
+struct Unary
+{
+  typedef typename A::value_type value_type;
+  A a;
+  Unary( const A & a0 ) : a(a0) {}
+  inline value_type operator()(int i0, int i1, int i2, int i3) const { return Op::apply(a(i0,i1,i2,i3)); }
+  inline bool conforms( const int *length ) const { return a.conforms(length); }
+  inline bool overlaps( const void *lo, const void *hi, const void *data, const int *step ) const
+    { return a.overlaps(lo,hi,data,step); }
+};
+
+struct Add { template<class T> static inline T apply(T a, T b){ return a+b; } };
+struct Sub { template<class T> static inline T apply(T a, T b){ return a-b; } };
+struct Mul { template<class T> static inline T apply(T a, T b){ return a*b; } };
+struct Div { template<class T> static inline T apply(T a, T b){ return a/b; } };
+struct Neg { template<class T> static inline T apply(T a){ return -a; } };
+struct Sqrt{ template<class T> static inline T apply(T a){ return (T)::sqrt((double)a); } };
+struct Fabs{ template<class T> static inline T apply(T a){ return a<0 ? -a : a; } };
+struct Sin { template<class T> static inline T apply(T a){ return (T)::sin((double)a); } };
+struct Cos { template<class T> static inline T apply(T a){ return (T)::cos((double)a); } };
+struct Exp { template<class T> static inline T apply(T a){ return (T)::exp((double)a); } };
+
+// ---------------------------------------------------------------------------------
+// The view returned by view(u,I0,I1,...): it can be used in expressions and assigned to.
+// ---------------------------------------------------------------------------------
+template<class T>
+class View : public Expr< ViewNode<T> >
+{
+public:
+  View( const ViewNode<T> & v ) : Expr< ViewNode<T> >(v) {}
+
+  template<class E>
+  View & operator=( const Expr<E> & rhs ) { assign(rhs); return *this; }
+  View & operator=( const View & rhs ) { assign(rhs); return *this; }
+  View & operator=( T value ) { assign(Expr< Scalar<T> >(Scalar<T>(value))); return *this; }
+
+  template<class E> View & operator+=( const Expr<E> & rhs ) { return *this = *this + rhs; }
+  template<class E> View & operator-=( const Expr<E> & rhs ) { return *this = *this - rhs; }
+  template<class E> View & operator*=( const Expr<E> & rhs ) { return *this = *this * rhs; }
+
+protected:
+
+  template<class E>
+  void assign( const Expr<E> & rhs )
+  {
+    const ViewNode<T> & d = this->e;
+    if( !rhs.conforms(d.length) )
+    {
+      printf("FusedArray::View::assign:ERROR: the arrays in the expression are not conformable\n");
+      abort();
+    }
+    const int n0=d.length[0], n1=d.length[1], n2=d.length[2], n3=d.length[3];
+    const int numberOfLines=n1*n2*n3;
+    if( n0*numberOfLines<=0 ) return;
+
+    if( !rhs.overlaps(d.first(),d.last(),d.data,d.step) )
+    {
+      // Evaluate in a single loop with no temporaries
+      T *dp=d.data;
+      const int s0=d.step[0], s1=d.step[1], s2=d.step[2], s3=d.step[3];
+      #ifdef OV_USE_OPENMP
+        #pragma omp parallel for if( n0*numberOfLines>100000 )
+      #endif
+      for( int line=0; line<numberOfLines; line++ )
+      {
+        const int i1=line%n1, i2=(line/n1)%n2, i3=line/(n1*n2);
+        T *dl = dp+i1*s1+i2*s2+i3*s3;
+        for( int i0=0; i0<n0; i0++ )
+          dl[i0*s0]=rhs(i0,i1,i2,i3);
+      }
+    }
+    else
+    {
+      // The destination is also read at other locations: evaluate into a temporary first (as A++ does)
+      T *temp = new T [n0*numberOfLines];
+      int k=0;
+      for( int i3=0; i3<n3; i3++ )
+      for( int i2=0; i2<n2; i2++ )
+      for( int i1=0; i1<n1; i1++ )
+      for( int i0=0; i0<n0; i0++ )
+        temp[k++]=rhs(i0,i1,i2,i3);
+      k=0;
+      for( int i3=0; i3<n3; i3++ )
+      for( int i2=0; i2<n2; i2++ )
+      for( int i1=0; i1<n1; i1++ )
+      for( int i0=0; i0<n0; i0++ )
+        d.data[i0*d.step[0]+i1*d.step[1]+i2*d.step[2]+i3*d.step[3]]=temp[k++];
+      delete [] temp;
+    }
+  }
+};
+
+// ---------------------------------------------------------------------------------
+// Build a view: I[d] are the indices for the first nI dimensions. The remaining
+// dimensions use the full range of the array.
+// ---------------------------------------------------------------------------------
+template<class T, class ArrayType>
+inline View<T>
+buildView( const ArrayType & u, T *p, int nI, const Internal_Index *I[] )
+{
+  ViewNode<T> v;
+  int rawStep=1;
+  v.data=p;
+  for( int d=0; d<maxDim; d++ )
+  {
+    int base, bound, stride;
+    if( d<nI )
+    {
+      base=I[d]->getBase(); bound=I[d]->getBound(); stride=I[d]->getStride();
+    }
+    else
+    {
+      base=u.getBase(d); bound=u.getBound(d); stride=1;
+    }
+    if( base<u.getBase(d) || bound>u.getBound(d) )
+    {
+      printf("FusedArray::view:ERROR: index [%i,%i] is out of bounds [%i,%i] for dimension %i\n",
+             base,bound,u.getBase(d),u.getBound(d),d);
+      abort();
+    }
+    // Array_View_Pointer3 points to the element with index 0 in each dimension
+    v.data+= base*rawStep;
+    v.step[d]=stride*rawStep;
+    v.length[d]= bound>=base ? (bound-base)/stride+1 : 0;
+    if( d<3 ) rawStep*=u.getRawDataSize(d);
+  }
+  return View<T>(v);
+}
+
+#define FUSED_ARRAY_VIEW_FUNCTIONS(ArrayType,T) \
+inline View<T> view( const ArrayType & u, const Internal_Index & I0 ) \
+{ const Internal_Index *I[]={&I0}; \
+  return buildView(u,(T*)u.Array_Descriptor.Array_View_Pointer3,1,I); } \
+inline View<T> view( const ArrayType & u, const Internal_Index & I0, const Internal_Index & I1 ) \
+{ const Internal_Index *I[]={&I0,&I1}; \
+  return buildView(u,(T*)u.Array_Descriptor.Array_View_Pointer3,2,I); } \
+inline View<T> view( const ArrayType & u, const Internal_Index & I0, const Internal_Index & I1, \
+                     const Internal_Index & I2 ) \
+{ const Internal_Index *I[]={&I0,&I1,&I2}; \
+  return buildView(u,(T*)u.Array_Descriptor.Array_View_Pointer3,3,I); } \
+inline View<T> view( const ArrayType & u, const Internal_Index & I0, const Internal_Index & I1, \
+                     const Internal_Index & I2, const Internal_Index & I3 ) \
+{ const Internal_Index *I[]={&I0,&I1,&I2,&I3}; \
+  return buildView(u,(T*)u.Array_Descriptor.Array_View_Pointer3,4,I); }
+
+FUSED_ARRAY_VIEW_FUNCTIONS(doubleSerialArray,double)
+FUSED_ARRAY_VIEW_FUNCTIONS(floatSerialArray,float)
+FUSED_ARRAY_VIEW_FUNCTIONS(intSerialArray,int)
+
+#undef FUSED_ARRAY_VIEW_FUNCTIONS
+
+// ---------------------------------------------------------------------------------
+// operators
+// ---------------------------------------------------------------------------------
+#define FUSED_ARRAY_BINARY_OPERATOR(op,Op) \
+template<class A, class B> \
+inline Expr< Binary<A,B,Op> > operator op ( const Expr<A> & a, const Expr<B> & b ) \
+{ return Expr< Binary<A,B,Op> >( Binary<A,B,Op>(a.e,b.e) ); } \
+template<class A> \
+inline Expr< Binary<A,Scalar<typename A::value_type>,Op> > \
+operator op ( const Expr<A> & a, typename A::value_type b ) \
+{ typedef Scalar<typename A::value_type> S; \
+  return Expr< Binary<A,S,Op> >( Binary<A,S,Op>(a.e,S(b)) ); } \
+template<class A> \
+inline Expr< Binary<Scalar<typename A::value_type>,A,Op> > \
+operator op ( typename A::value_type a, const Expr<A> & b ) \
+{ typedef Scalar<typename A::value_type> S; \
+  return Expr< Binary<S,A,Op> >( Binary<S,A,Op>(S(a),b.e) ); }
+
+FUSED_ARRAY_BINARY_OPERATOR(+,Add)
+FUSED_ARRAY_BINARY_OPERATOR(-,Sub)
+FUSED_ARRAY_BINARY_OPERATOR(*,Mul)
+FUSED_ARRAY_BINARY_OPERATOR(/,Div)
+
+#undef FUSED_ARRAY_BINARY_OPERATOR
+
+#define FUSED_ARRAY_UNARY_FUNCTION(fn,Op) \
+template<class A> \
+inline Expr< Unary<A,Op> > fn ( const Expr<A> & a ) \
+{ return Expr< Unary<A,Op> >( Unary<A,Op>(a.e) ); }
+
+FUSED_ARRAY_UNARY_FUNCTION(operator-,Neg)
+FUSED_ARRAY_UNARY_FUNCTION(sqrt,Sqrt)
+FUSED_ARRAY_UNARY_FUNCTION(fabs,Fabs)
+FUSED_ARRAY_UNARY_FUNCTION(abs,Fabs)
+FUSED_ARRAY_UNARY_FUNCTION(sin,Sin)
+FUSED_ARRAY_UNARY_FUNCTION(cos,Cos)
+FUSED_ARRAY_UNARY_FUNCTION(exp,Exp)
+
+#undef FUSED_ARRAY_UNARY_FUNCTION
+
+}  // end namespace FusedArray
+
+#endif
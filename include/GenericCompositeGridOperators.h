@@ -20,6 +20,7 @@
 // extern BoundaryConditionParameters Overture::defaultBoundaryConditionParameters();
 
 class GridFunctionParameters;
+class GhostBoundaryUpdate;
 
 
 //-----------------------------------------------------------------------------------
@@ -420,6 +421,7 @@ class GenericCompositeGridOperators : public GenericCollectionOperators
                                                            // (this may point to a derived class object)
   bool twilightZoneFlow;
   OGFunction *twilightZoneFlowFunction;
+  GhostBoundaryUpdate *ghostBoundaryUpdate;  // cached parallel ghost boundary schedules (new'd on first use)
 
   void setup();
 
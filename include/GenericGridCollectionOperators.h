@@ -19,6 +19,7 @@
 // extern BoundaryConditionParameters Overture::defaultBoundaryConditionParameters();
 
 class GridFunctionParameters;
+class GhostBoundaryUpdate;
 
 
 //-----------------------------------------------------------------------------------
@@ -419,6 +420,7 @@ class GenericGridCollectionOperators : public GenericCollectionOperators
                                                            // (this may point to a derived class object)
   bool twilightZoneFlow;
   OGFunction *twilightZoneFlowFunction;
+  GhostBoundaryUpdate *ghostBoundaryUpdate;  // cached parallel ghost boundary schedules (new'd on first use)
 
   void setup();
 
@@ -576,6 +576,8 @@ SCALAR_FUNCTION_COEFFICIENTS(divVectorScalarCoefficients)
   int numberOfComponentsForCoefficients;       // for dimensioning coefficient matrices
   int twilightZoneFlow;                        // 0, 1 or 2.
   OGFunction *twilightZoneFlowFunction;
+  bool updateParallelGhostBoundaries;          // if false, fixBoundaryCorners does not update the parallel
+                                               // ghost boundaries (the grid collection operators update all grids at once)
 
   // These next functions are called by finishBoundaryConditions
 
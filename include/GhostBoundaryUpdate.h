@@ -0,0 +1,66 @@
+#ifndef GHOST_BOUNDARY_UPDATE_H
+#define GHOST_BOUNDARY_UPDATE_H
+
+#include "GridCollectionFunction.h"
+#include "ParallelUtility.h"
+
+// =====================================================================================
+//  Update the parallel ghost boundaries of many distributed arrays (e.g. all component
+//  grids and components of a grid function) with one message per neighbouring processor.
+//  The P++ updateGhostBoundaries sends separate messages for each array.
+//
+//  The communication schedule is computed once and cached. The cache key holds the array
+//  bounds, the parallel ghost widths, the local boxes on every processor and the components,
+//  so a schedule is not reused after a redistribution. clear() discards the cached schedules.
+// =====================================================================================
+class GhostBoundaryUpdate
+{
+public:
+
+GhostBoundaryUpdate();
+~GhostBoundaryUpdate();
+
+// update the parallel ghost boundaries of all (or some) component grids of u
+int updateGhostBoundaries( realGridCollectionFunction & u, const Range & C=nullRange,
+                           const IntegerArray & gridsToUpdate=Overture::nullIntArray() );
+
+// update the parallel ghost boundaries of a list of arrays
+int updateGhostBoundaries( int numberOfArrays, realArray **u, const Range & C=nullRange );
+
+// discard all cached schedules
+void clear();
+
+// keep at most this many schedules
+void setMaximumNumberOfSchedules( int num );
+
+// number of messages sent by the last update
+int getNumberOfMessages() const;
+
+static int debug;
+
+protected:
+
+struct Schedule
+{
+  std::vector<int> key;
+  std::vector<int> processor;                 // neighbouring processors
+  std::vector<int> sendOffset, receiveOffset; // boxes for neighbour m are [offset[m],offset[m+1])
+  std::vector<int> sendBox, receiveBox;       // boxes: array number followed by base,bound for 4 dimensions
+  std::vector<int> sendLength, receiveLength; // number of values sent to/received from each neighbour
+};
+
+void getScheduleKey( int numberOfArrays, realArray **u, const Range & C, std::vector<int> & key ) const;
+Schedule* buildSchedule( int numberOfArrays, realArray **u, const Range & C );
+
+std::vector<Schedule*> schedules;  // most recently used first
+int maximumNumberOfSchedules;
+int numberOfMessages;
+
+private:
+
+GhostBoundaryUpdate( const GhostBoundaryUpdate & );
+GhostBoundaryUpdate & operator=( const GhostBoundaryUpdate & );
+
+};
+
+#endif
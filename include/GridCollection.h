@@ -146,7 +146,8 @@ class GridCollectionData:
       const Integer&      level,
       const Integer       k = 0);
 
-    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo );
+    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo,
+                                            bool reuseUnchangedGrids=false );
 
     virtual void deleteRefinement(const Integer& k);
     virtual void deleteRefinementLevels(const Integer level = 0);
@@ -483,7 +484,8 @@ class GridCollection:
     }
    
     // replace refinement level level0 and higher
-    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo );
+    virtual Integer replaceRefinementLevels(int level0, int numberOfRefinementLevels0, IntegerArray **gridInfo,
+                                            bool reuseUnchangedGrids=false );
 
   //
 //  Delete all multigrid levels of refinement grid k.
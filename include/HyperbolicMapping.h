@@ -413,6 +413,8 @@ int implicitSolve(RealArray & xTri,
 		  RealArray & normXt,
 		  TridiagonalSolver & tri,
 		  int stepNumber);
+
+int factorAndSolve( TridiagonalSolver & tri, const int & direction, RealArray & xTri );
   
 
 int createCurveOnSurface( GenericGraphicsInterface & gi,
@@ -600,6 +602,7 @@ int nurbsDegree;
 bool useTriangulation;      // if true, use the triangulation of a CompositeSurface for marching.
 bool projectOntoReferenceSurface;  // if true, project points found using the triangulation onto the actual surface
 bool stopOnNegativeCells;   // stop the generation when a negative cell is detected
+int numberOfThreads;        // number of threads for the line solves and smoothing at each marching step
 
 int saveReferenceSurface;  // // 0=do not save, 1=save for 2D grids, 2=save for all grids 
 bool plotBoundaryConditionMappings;
@@ -10,6 +10,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef OV_USE_OLD_STL_HEADERS
+#include <map>
+#include <vector>
+#else
+#include <map.h>
+#include <vector.h>
+#endif
+
 #define RECBUF  81      /* Buffer size for IGS record */
 #define KEYPOS  72      /* Key word for extracting IGS file */
 
@@ -161,6 +169,12 @@ class IgesReader
 
   int numberOfEntities();
 
+  // decode the parameter data of all entities (in parallel) so that readData does not need to read the file
+  int prefetchParameterData( int numberOfThreads=0 );
+
+  // keep the decoded parameter data in memory (the default)
+  void setCacheParameterData( bool trueOrFalse=true );
+
   int processFile();
 
   int getData(RealArray & data, int max_data);
@@ -176,6 +190,9 @@ class IgesReader
 
   int getSequenceNumber(const char *buff);  // return seq number from Parameter line
 
+  // decode the parameter data record starting at a given location in the PD section (thread safe)
+  int decodeParameterData( int parameterDataPointer, std::vector<double> & values ) const;
+
 
  private:
   enum
@@ -186,6 +203,10 @@ class IgesReader
   
 
   IntegerArray entityInfo;     // holds info about objects in file (info found in the directory)
+  IntegerArray sequenceIndex;  // sequenceIndex((seq-1)/2) = item with DE sequence number seq (or -1)
+
+  bool cacheParameterData;
+  std::map<int,std::vector<double> > parameterCache;  // decoded parameter data, by parameter data pointer
 
   int entityCount;
 
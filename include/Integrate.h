@@ -68,6 +68,12 @@ class Integrate
                       RealArray & integral,
                       const int & surfaceNumber = -1 );
 
+  // Compute the surface integrals of some components over a list of surfaces
+  int surfaceIntegrals(const RealCompositeGridFunction & u, 
+		       const Range & C, 
+		       const IntegerArray & surfaceNumbers,
+		       RealArray & integral );
+
   int updateToMatchGrid( CompositeGrid & cg );
 
   // use AMR grids when computing integrals on grid functions that have AMR
@@ -100,6 +106,10 @@ class Integrate
 
   int initialize();
   int computeWeights();
+  real getGridCheckSum();
+  void getGridGeometryKey( real key[4] );
+  int localSurfaceIntegral(const RealCompositeGridFunction & u, const Range & C, real *integral,
+                           const int & surfaceNumber );
   int computeSurfaceWeights(int surfaceNumber=-1 );
   
   int computeLeftNullVector();
@@ -20,6 +20,12 @@ enum LoadBalancerTypeEnum
   numberOfLoadBalanceTypes
 };
 
+enum WorkLoadTypeEnum
+{
+  gridPointWorkLoads=0, // work-load is proportional to the number of grid points (default)
+  measuredWorkLoads     // work-load is based on cpu times measured at run time (see addMeasuredWorkLoad)
+};
+
 
 LoadBalancer();
 ~LoadBalancer();
@@ -67,6 +73,31 @@ int setTargetMaximumLoadImbalance( real target );
 
 int update( GenericGraphicsInterface & gi );
 
+// --- feedback load balancing from measured work-loads ---
+
+// choose how work-loads are assigned (grid points or measured cpu times):
+int setWorkLoadType( WorkLoadTypeEnum type );
+WorkLoadTypeEnum getWorkLoadType() const;
+
+// accumulate the cpu time spent on this processor for a grid (solver, interpolation, BC's, ...):
+int addMeasuredWorkLoad( int grid, real cpuTime );
+int resetMeasuredWorkLoads();
+
+// (collective) combine the measured work-loads from all processors:
+int computeMeasuredWorkLoads( GridCollection & gc );
+
+// measured work per grid point for grids derived from a given base grid (1 if not measured):
+real getWorkLoadPerPoint( int baseGrid ) const;
+
+// relative load imbalance measured at run time (from the last call to computeMeasuredWorkLoads)
+real getMeasuredLoadImbalance() const;
+
+// (collective) return true if the measured imbalance exceeds the rebalance threshold:
+bool loadBalanceIsNeeded( GridCollection & gc );
+
+// rebalance when the measured relative load imbalance exceeds this value:
+int setRebalanceThreshold( real threshold );
+
 protected:
 
 // update statistics
@@ -78,6 +109,13 @@ int *processorID;  // list of processor id's we load balance over
 LoadBalancerTypeEnum loadBalancer;
 real targetMaximumLoadImbalance;  // gives the target maximum relative load imbalance
 
+// measured work-loads:
+WorkLoadTypeEnum workLoadType;
+RealArray localMeasuredWorkLoad;  // cpu time per grid accumulated on this processor
+RealArray workLoadPerPoint;       // measured work per grid point, one entry per base grid
+real measuredLoadImbalance;       // relative imbalance from the measured times
+real rebalanceThreshold;          // rebalance if measuredLoadImbalance > rebalanceThreshold
+
 static int debug;
 
 // These are for statistics:
@@ -58,6 +58,14 @@ class MappingProjectionParameters
   int setProjectOntoReferenceSurface(const bool & trueOrFalse =true );
   bool projectOntoReferenceSurface() const{ return projectOntoTheReferenceSurface;} //
   
+  // project many points at once (groups of nearby points, threaded, tree search over the triangles)
+  int setUseBatchedProjection(const bool & trueOrFalse =true );
+  bool useBatchedProjection() const{ return batchedProjection;} //
+
+  // number of threads for the batched projection (0 = use the OpenMP default)
+  int setNumberOfThreads( const int numThreads );
+  int getNumberOfThreads() const{ return numberOfThreads;} //
+  
   // reset the parameters:
   int reset();
 
@@ -80,6 +88,8 @@ class MappingProjectionParameters
   bool matchNormals;
   bool onlyChangePointsAdjustedForCorners;
   bool projectOntoTheReferenceSurface;
+  bool batchedProjection;
+  int numberOfThreads;
 
   // All the arrays are saved in the following two arrays of pointers
   intArray *integerArrayParameter[numberOfIntegerArrayParameters];
@@ -205,6 +205,17 @@ public:
   virtual void mapS( const RealArray & r, RealArray & x, RealArray &xr = Overture::nullRealArray(),
                     MappingParameters & params =Overture::nullMappingParameters());
 
+  // map a grid of points (uses a fast tensor-product evaluation for surfaces)
+  virtual void mapGrid(const realArray & r, realArray & x, realArray & xr =Overture::nullRealDistributedArray(),
+		       MappingParameters & params=Overture::nullMappingParameters() );
+
+  virtual void mapGridS(const RealArray & r, RealArray & x, RealArray & xr =Overture::nullRealArray(),
+		        MappingParameters & params=Overture::nullMappingParameters() );
+
+  // evaluate a surface on the tensor product of parameter values r0(0:m0-1) X r1(0:m1-1)
+  int mapTensorProductS( const RealArray & r0, const RealArray & r1, RealArray & x, 
+                         RealArray & xr = Overture::nullRealArray() );
+
   // transform using a 3x3 matrix
   int matrixTransform( const RealArray & r );
   
@@ -403,6 +414,10 @@ public:
 		     const RealArray & uKnot,
 		     real *ders );
   
+  // tensor-product evaluation of a surface on a grid of parameter values
+  int tensorProductEvaluate( const int m0, const real *r0, const int m1, const real *r1,
+			     real *xp, const int xDim0, real *xrp, const int xrDim0, const int xrDim1 );
+
   // vectorized versions
   void findSpan(const int & n ,
 		const int & p,
@@ -134,6 +134,18 @@ virtual realSerialArray& gd( realSerialArray & result,   // put result here
 			     const Index & I3, const Index & N, 
                              const real t=0., int option =0  ) = 0;
 
+// Evaluate several derivatives of all components N in one pass (serial arrays):
+//   result[k](I1,I2,I3,N) = derivative (ntd,nxd,nyd,nzd)=derivative(0:3,k), k=0,1,...,derivative.getLength(1)-1
+// The default version calls gd once for each derivative.
+virtual int gdList( realSerialArray *result[],
+                    const IntegerArray & derivative,
+                    const realSerialArray & x,
+                    const int numberOfDimensions,
+                    const bool isRectangular,
+                    const Index & I1, const Index & I2, 
+                    const Index & I3, const Index & N, 
+                    const real t=0. );
+
 // add this:
 //  virtual realSerialArray& gd( realSerialArray & result,   // put result here
 //  			     const realSerialArray & x,  // coordinates to use if isRectangular==true
@@ -262,6 +274,13 @@ virtual realSerialArray& gd( realSerialArray & result,   // put result here
 		      RealDistributedArray & y, 
 		      RealDistributedArray & z );
 
+ protected:
+
+  // bounds for gdList: I1,I2,I3 intersected with the bounds of all results
+  bool getListBounds( realSerialArray *result[], const int numberOfResults, 
+                      const Index & I1, const Index & I2, const Index & I3, const Index & N,
+		      int & i1a, int & i1b, int & i2a, int & i2b, int & i3a, int & i3b );
+
 };
 
 #endif 
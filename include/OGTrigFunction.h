@@ -183,6 +183,16 @@ class OGTrigFunction : public OGFunction
 			     const Index & I3, const Index & N, 
                              const real t=0., int option =0  );
 
+  // evaluate several derivatives of all components in one pass
+  virtual int gdList( realSerialArray *result[],
+                      const IntegerArray & derivative,
+                      const realSerialArray & x,
+                      const int numberOfDimensions,
+                      const bool isRectangular,
+                      const Index & I1, const Index & I2, 
+                      const Index & I3, const Index & N, 
+                      const real t=0. );
+
 
   realCompositeGridFunction operator()(CompositeGrid & cg);
   realCompositeGridFunction operator()(CompositeGrid & cg, const Index & N=nullIndex);
@@ -0,0 +1,86 @@
+#ifndef REDISTRIBUTION_PLAN_H
+#define REDISTRIBUTION_PLAN_H
+
+#include "ParallelUtility.h"
+
+#ifndef OV_USE_OLD_STL_HEADERS
+#include <vector>
+#else
+#include <vector.h>
+#endif
+
+// =====================================================================================
+//  A plan for the copies  dest[a]=src[a], a=0,1,...,numberOfArrays-1, where dest[a] and
+//  src[a] have the same bounds but different parallel distributions, e.g. a solver and an
+//  I/O distribution, or the same grid on two different sets of processors.
+//
+//  The plan is built once. It stores the index boxes to send to and receive from each
+//  processor, and all arrays are packed into one message per pair of processors. The plan
+//  can then be executed many times for any arrays with the same bounds and distributions,
+//  either blocking (execute) or asynchronously (beginExecute ... finishExecute). Parallel
+//  ghost points of the destination are assigned; those of the source are not used.
+//
+//  Copies of sub-arrays or strided views should use CopyArray::copyArray.
+// =====================================================================================
+class RedistributionPlan
+{
+public:
+
+RedistributionPlan();
+~RedistributionPlan();
+
+// build the plan for dest[a]=src[a]
+int build( int numberOfArrays, realArray **dest, const realArray **src );
+
+// return true if the plan was built for arrays with these bounds and distributions
+bool isValidFor( int numberOfArrays, realArray **dest, const realArray **src ) const;
+
+// copy using the plan (the plan is rebuilt if it does not match the arrays)
+int execute( int numberOfArrays, realArray **dest, const realArray **src );
+int execute( realArray & dest, const realArray & src );
+
+// asynchronous copy: post the messages and copy the local data, then wait and unpack
+int beginExecute( int numberOfArrays, realArray **dest, const realArray **src );
+int finishExecute();
+
+// discard the plan
+void clear();
+
+// number of messages sent by one execution
+int getNumberOfMessages() const;
+
+// copy with a plan taken from (or added to) a cache of recently used plans
+static int copy( int numberOfArrays, realArray **dest, const realArray **src );
+static void clearCache();
+
+static int debug;
+
+protected:
+
+static void getKey( int numberOfArrays, realArray **dest, const realArray **src, std::vector<int> & key );
+
+// start an execution with the current plan (which must match the arrays)
+int beginExecuteWithPlan( int numberOfArrays, realArray **dest, const realArray **src );
+
+std::vector<int> key;
+std::vector<int> processor;                 // processors that we exchange data with
+std::vector<int> sendOffset, receiveOffset; // boxes for processor m are [offset[m],offset[m+1])
+std::vector<int> sendBox, receiveBox;       // boxes: array number followed by base,bound for 4 dimensions
+std::vector<int> sendLength, receiveLength; // number of values sent to/received from each processor
+std::vector<int> copyBox;                   // boxes copied on this processor (same format)
+
+// state of an asynchronous execution
+std::vector<real> sendBuffer, receiveBuffer;
+std::vector<realSerialArray*> destLocal;
+void *requests;   // MPI_Request's for the messages
+bool executing;
+int tag;
+
+private:
+
+RedistributionPlan( const RedistributionPlan & );
+RedistributionPlan & operator=( const RedistributionPlan & );
+
+};
+
+#endif
@@ -74,6 +74,10 @@ class Regrid
 
   void setUseSmartBisection( bool trueOrFalse=true );
 
+  void setUseParallelClustering( bool trueOrFalse=true );
+
+  void setReuseUnchangedRefinements( bool trueOrFalse=true ); // keep refinement grids that do not change
+
   void setGridAdditionOption( GridAdditionOption gridAdditionOption );
   GridAdditionOption getGridAdditionOption() const;
 
@@ -136,6 +140,8 @@ class Regrid
     BOX getBox( const intSerialArray & ia );
   #endif
 
+  int enforceMinimumBoxWidth( Box & box, const Box & boundingBox ) const;
+
   real getEfficiency(const intSerialArray & ia, const BOX & box );
   
   int buildGrids( GridCollection & gc, 
@@ -162,6 +168,11 @@ class Regrid
 		     int baseLevel  = -1 );  
 
   int splitBox( BOX & box, const intSerialArray & ia, BoxList & boxList, int refinementLevel );
+
+  // parallel/threaded version of splitBox:
+  int clusterTaggedCells( const BOX & mainBox, const intSerialArray & ia, BoxList & boxList, int refinementLevel );
+  int clusterBox( const BOX & box, int *tagged, int numTagged, int numTaggedGlobal, BoxList & boxList, 
+                  int refinementLevel, bool useTasks );
   int splitBoxRotated( RotatedBox & box, ListOfRotatedBox & boxList, 
                        realArray & xa, int refinementLevel );
 
@@ -192,6 +203,8 @@ class Regrid
   int minimumBoxWidth;
   bool useSmartBisection;
   bool mergeBoxes;
+  bool useParallelClustering;  // use clusterTaggedCells instead of splitBox
+  bool reuseUnchangedRefinements; // keep refinement grids in gcNew that are not changed by the regrid
 
   int myid;
 
@@ -194,6 +194,11 @@ public:
   //==============================================================  
   IntegerArray getWidth() const; 
 
+  // Access to the weights and their offsets, i=0,...,getNumberOfWeights()-1
+  int getNumberOfWeights() const;
+  Real getWeight(int i) const;
+  int getOffset(int i, int axis) const;
+
   int offsetExist(const Point &p) const;
   // if return is TRUE, i holds the index for the point 
   int offsetExist(const Point &p, int &i) const;
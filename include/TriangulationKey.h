@@ -0,0 +1,26 @@
+#ifndef TRIANGULATION_KEY_H
+#define TRIANGULATION_KEY_H
+
+#include "Mapping.h"
+
+// =================================================================================================
+//  Functions to build the key that identifies a triangulation (TrimmedMapping, CompositeTopology).
+//  The key is two 32-bit hashes, h[0] and h[1], of the data that determines the triangulation.
+//  Start with h[0]=2166136261u, h[1]=0x9747b28cu. Reals are hashed as doubles.
+// =================================================================================================
+
+// add bytes to the key
+void addToTriangulationKey( unsigned int *h, const void *data, int numberOfBytes );
+
+void addToTriangulationKey( unsigned int *h, int value );
+
+void addToTriangulationKey( unsigned int *h, double value );
+
+// add the dimensions and all values of an array
+void addToTriangulationKey( unsigned int *h, const RealArray & a );
+
+// add a surface or curve: the domain bounds and grid dimensions, and the data that defines it --
+// the order, knots and control points of a NURBS or else all points of its grid.
+void addToTriangulationKey( unsigned int *h, Mapping & map );
+
+#endif
@@ -73,6 +73,9 @@ class TridiagonalSolver
   // For backward compatibility one can set the block solves to use the transpose of the blocks
   void setBlockOrdering( bool useTransposeOfBlocks = true );
 
+  // Use the batched (and multi-threaded) solver for block systems
+  void setUseBatchedSolver( bool trueOrFalse = true );
+
  protected:
 
   int tridiagonalFactor();
@@ -100,6 +103,10 @@ class TridiagonalSolver
   int scalarBlockSolve(RealArray & r, int i1, int i2, int i3);
   int scalarBlockPeriodicFactor(int i1, int i2, int i3);
   int scalarBlockPeriodicSolve(RealArray & r, int i1, int i2, int i3);
+
+  // batched block solver: many lines at once, block sizes 2..5
+  int batchedBlockFactor();
+  int batchedBlockSolve(RealArray & r);
   
 
   // *** old versions using transpose -- keep for now 
@@ -116,13 +123,14 @@ class TridiagonalSolver
   RealArray a,b,c,d,e,w1,w2;
   Range Iv[3], &I1, &I2, &I3;
 
-  int blockSize;  // we can do 1x1, 2x2 and 3x3 blocks
+  int blockSize;  // we can do 1x1, 2x2 and 3x3 blocks (and 4x4, 5x5 with the batched solver)
   bool scalarSystem;
   int bandWidth;   // 3 or 5 for tridiagonal or penta-diagonal systems
 
   bool useOptimizedC;
   
   bool useOldBlockOrdering;  // original block solves used the transpose of the blocks!
+  bool useBatchedSolver;     // solve many block systems at once 
 
   FILE *debugFile;
   static int debug;
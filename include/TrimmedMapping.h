@@ -203,6 +203,7 @@ class TrimmedMapping : public Mapping
   int setElementDensityToleranceForTriangulation( real elementDensity=.05 );
 
   int getTriangulationParameters( real &area, real &minAngle, real &elementDensity ) const;
+  int getTriangulationKey( int key[2] );
 
   int snapCurvesToIntersection( GenericGraphicsInterface & gi, NurbsMapping & trimCurve,
                                 int &curve1, int &curve2, int curve1End, int curve2End,
@@ -247,6 +248,7 @@ class TrimmedMapping : public Mapping
   real minAngleForTriangulation; // use this to reduce allowable angle to we don't get too many triangles: -1=default
   real elementDensityTolerance;  // -1 = use default
   real maxArea;    // approximate maximum area for triangles, 0=use default
+  int triangulationKey[2]; // key (hash of the surface, trim curves and parameters) for the current triangulation
 
   static real defaultMinAngleForTriangulation;
   static real defaultElementDensityToleranceForTriangulation; // num grid pts based on curvature/(this value)
@@ -6,11 +6,13 @@
 #ifndef OV_USE_OLD_STL_HEADERS
 #include <map>
 #include <list>
+#include <set>
 #include <string>
 #include <vector>
 #else
 #include <map.h>
 #include <list.h>
+#include <set.h>
 #include <string>
 #include <vector.h>
 #endif
@@ -253,6 +255,9 @@ public:
   
   // project points onto the surface
   int project( realArray & x, MappingProjectionParameters & mpParameters );
+
+  // project points onto the surface, points are processed in spatially sorted groups by multiple threads
+  int projectBatch( realArray & x, MappingProjectionParameters & mpParameters );
   
   int findClosestEntity( UnstructuredMapping::EntityTypeEnum etype, real x, real y, real z=0. );
 
@@ -320,13 +325,14 @@ public:
   inline bool dumpTags() const { return dumpTagsToHDF; }
   inline bool dumpTags( bool dt ) { dumpTagsToHDF = dt; return dumpTagsToHDF; }
 
-  EntityTag & addTag( const EntityTypeEnum entityType, const int entityIndex, const std::string tagName,
+  // addTag and getTag return a copy of the tag: use setTagData to change the data of a tag
+  EntityTag addTag( const EntityTypeEnum entityType, const int entityIndex, const std::string tagName,
 		      const void *tagData, const bool copyTag=false, const int tagSize=0 );
   int deleteTag( const EntityTypeEnum entityType, const int entityIndex, const EntityTag &tagToDelete );
   int deleteTag( const EntityTypeEnum entityType, const int entityIndex, const std::string tagToDelete );
   
   bool hasTag( const EntityTypeEnum entityType, const int entityIndex, const std::string tag );
-  EntityTag & getTag( const EntityTypeEnum entityType, const int entityIndex, const std::string tagName);
+  EntityTag getTag( const EntityTypeEnum entityType, const int entityIndex, const std::string tagName);
   void * getTagData( const EntityTypeEnum entityType, const int entityIndex, const std::string tag );
 
   int setTag( const EntityTypeEnum entityType, const int entityIndex, const EntityTag & newTag );
@@ -336,25 +342,31 @@ public:
   void maintainTagToEntityMap( bool v );
   bool maintainsTagToEntityMap() const;
 
+  /// return the number of entities of a given type with the tag tagName
+  int numberOfTaggedEntities( const EntityTypeEnum entityType, const std::string tagName ) const;
+  /// fill entityList with the (increasing) indices of the entities of a given type with the tag tagName
+  int getTaggedEntities( const EntityTypeEnum entityType, const std::string tagName, std::vector<int> & entityList ) const;
+
   /// iterator for going through the tags in a specific entity
-  typedef std::list<EntityTag*>::iterator       entity_tag_iterator;
-  typedef std::list<EntityTag*>::const_iterator       const_entity_tag_iterator;
+  typedef std::vector<EntityTag*>::iterator       entity_tag_iterator;
+  typedef std::vector<EntityTag*>::const_iterator       const_entity_tag_iterator;
   
   /// iterator for going throught the entities with a specific tag
-  typedef std::list<IDTuple>::iterator          tag_entity_iterator;
-  typedef std::list<IDTuple>::const_iterator          const_tag_entity_iterator;
+  typedef std::set<IDTuple>::iterator          tag_entity_iterator;
+  typedef std::set<IDTuple>::const_iterator          const_tag_entity_iterator;
 
-  /// return the beginning of the tags for an entity specified with et and index
+  /// return the beginning of the tags for an entity specified with et and index; 
+  /// note adding, deleting or changing a tag on this entity invalidates the iterators
   inline entity_tag_iterator       entity_tag_begin(EntityTypeEnum et, int index) 
-    { return entityTags[IDTuple(et,index)].begin(); }
+    { return entityTagList(et,index).tags.begin(); }
   inline const_entity_tag_iterator entity_tag_begin(EntityTypeEnum et, int index) const
-    { return entityTags[IDTuple(et,index)].begin(); }
+    { return entityTagList(et,index).tags.begin(); }
   
   /// return the end of the tags for an entity specified with et and index
   inline entity_tag_iterator       entity_tag_end(EntityTypeEnum et, int index)
-  { return entityTags[IDTuple(et,index)].end(); }
+  { return entityTagList(et,index).tags.end(); }
   inline const_entity_tag_iterator entity_tag_end(EntityTypeEnum et, int index) const
-  { return entityTags[IDTuple(et,index)].end(); }
+  { return entityTagList(et,index).tags.end(); }
   
   /// return the beginning of the entities with the tag tagName; note this inverse mapping will be built if it does not already exist
   inline tag_entity_iterator      tag_entity_begin(std::string tagName)
@@ -400,6 +412,21 @@ public:
   /// upwardOffsets allows random access into the upward adjacencies for a given entity
   intArray *upwardOffsets[int(NumberOfEntityTypes)-1][int(NumberOfEntityTypes)-1];
 
+  /// compressed sparse row copies of the downward adjacencies (from>to) used by the adjacency iterators:
+  /// the entities adjacent to e are downwardAdjacency[from][to][i], downwardOffsets[from][to][e] <= i < downwardOffsets[from][to][e+1]
+  int *downwardOffsets[int(NumberOfEntityTypes)-1][int(NumberOfEntityTypes)-1];
+  int *downwardAdjacency[int(NumberOfEntityTypes)-1][int(NumberOfEntityTypes)-1];
+  char *downwardOrientation[int(NumberOfEntityTypes)-1][int(NumberOfEntityTypes)-1];
+  /// number of entities (of type from) in the downward adjacency tables
+  int downwardTableSize[int(NumberOfEntityTypes)-1][int(NumberOfEntityTypes)-1];
+
+  /// make sure the connectivity (and adjacency table for downward adjacencies) exists before iterating
+  inline void prepareAdjacency(EntityTypeEnum from, EntityTypeEnum to) const
+  {
+    if ( !connectivityExists(from,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from,to);
+    if ( from>to && from<=Region && !downwardAdjacency[from][to] ) ((UnstructuredMapping *)this)->buildAdjacencyTable(from,to);
+  }
+
   /// entitySize maintains the current number of entities of a given type
   ArraySimpleFixed<int,int(NumberOfEntityTypes)-1,1,1,1> entitySize;
   /// entityCapacity maintains the current allocated size of the container arrays for a particular entity
@@ -483,6 +510,14 @@ public:
   /// delete ALL thet connectivity information
   void deleteConnectivity();
 
+  /// build the compressed sparse row table used by the adjacency iterators for the downward adjacency from->to
+  bool buildAdjacencyTable(EntityTypeEnum from, EntityTypeEnum to);
+  /// return true if the compressed sparse row table for the downward adjacency from->to exists
+  inline bool adjacencyTableExists(EntityTypeEnum from, EntityTypeEnum to) const 
+  { return downwardAdjacency[from][to]!=0; }
+  /// delete the adjacency tables that refer to a particular entity type (all tables if type==Invalid)
+  void deleteAdjacencyTables(EntityTypeEnum type=Invalid);
+
   /// expand the ghost boundary by a layer
   void expandGhostBoundary( int bc=-1 );
 
@@ -505,6 +540,18 @@ protected:
   int debugs;                   // debug for stitching
 
   GeometricADT3dInt *search;  // used to search for triangles nearby a point (Alternating Digital Tree)
+
+  // packed bounding volume hierarchy over the (triangular) elements used by projectBatch
+  struct ElementBVH
+  {
+    std::vector<real> box;    // box[6*n+2*axis+side] : bounding box of node n
+    std::vector<int> node;    // node[2*n] : first child (interior node) or first position in element (leaf)
+                              // node[2*n+1] : number of elements in a leaf, 0 for an interior node
+    std::vector<int> element; // elements ordered by leaf
+    std::vector<int> position; // position[e] : position of element e in element
+    std::vector<real> vertex; // vertex[9*k+3*v+axis] : vertex v of element[k]
+    void clear(){ box.clear(); node.clear(); element.clear(); position.clear(); vertex.clear(); }
+  } elementBVH;
   
 
   realArray node;
@@ -567,6 +614,10 @@ protected:
 			  int maxNumberOfElements, int maxNumberOfFaces );
 
   int buildSearchTree();
+  int buildElementBVH();
+  int findClosestElement( const real *xx, int eGuess, real & dist2, real *xp, real *rp ) const;
+  int projectIncremental( int i, int eGuess, real *xx, real *xa, real & r, real & s, real *xt,
+			  bool & cornerFound, bool & firstCorner, MappingProjectionParameters & mpParams );
 
   int computeConnection(int s, int s2, 
 			intArray *bNodep,
@@ -592,9 +643,34 @@ protected:
 
   // kkc General tagging support added 0802
   // the user should *never* see these levely template types.  we only use them internally
+
+  /// the tags with one name on one entity type are stored in a column indexed by the entity
+  struct TagColumn
+  {
+    TagColumn() : numberOfTags(0) {}
+    std::vector<bool> tagged;            // tagged[e] is true if entity e has the tag
+    std::vector<const void*> data;       // data of tags that do not copy their data (allocated on first non-null data)
+    std::map<int,EntityTag*> copiedTags; // tags that own a copy of their data
+    int numberOfTags;                    // number of entities with the tag
+  };
+  typedef std::map<std::string,TagColumn> TagColumnMap;
+  TagColumnMap tagColumns[NumberOfEntityTypes];   // tagColumns[entityType][tagName]
+
+  /// the tags of one entity, built from the columns by entity_tag_begin
+  struct EntityTagList
+  {
+    std::vector<EntityTag*> tags;   // the stored tags that copy their data, and views of the other tags
+    std::vector<EntityTag> views;   // storage of the views
+  };
+
+  const TagColumn *findTagColumn( const EntityTypeEnum entityType, const std::string & tagName ) const;
+  EntityTagList & entityTagList( const EntityTypeEnum entityType, const int entityIndex ) const;
+  void invalidateEntityTagList( const EntityTypeEnum entityType, const int entityIndex ) const;
+  void destroyTags();
+
   bool maintainsTagEntities;
-  mutable std::map<IDTuple, std::list<EntityTag*> > entityTags; // always built when tags are used
-  mutable std::map<std::string, std::list<IDTuple>, std::less<std::string> > tagEntities; // optionally built if requested.
+  mutable std::map<IDTuple, EntityTagList> entityTags; // tags of an entity, built by entity_tag_begin
+  mutable std::map<std::string, std::set<IDTuple>, std::less<std::string> > tagEntities; // optionally built if requested.
 
   bool dumpTagsToHDF;
 
@@ -914,7 +990,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_begin(EntityTypeEnum fromT, int fromE, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(fromT,to) ) ((UnstructuredMapping *)this)->buildConnectivity(fromT,to);
+  prepareAdjacency(fromT,to);
   return UnstructuredMappingAdjacencyIterator(*this, fromT, fromE, to, 0, skipGhostEntities);
 }
 
@@ -922,7 +998,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_end(EntityTypeEnum fromT, int fromE, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(fromT,to) ) ((UnstructuredMapping *)this)->buildConnectivity(fromT,to);
+  prepareAdjacency(fromT,to);
   return UnstructuredMappingAdjacencyIterator(*this, fromT, fromE, to, 1, skipGhostEntities);
 }
 
@@ -930,7 +1006,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_begin(UnstructuredMappingIterator from, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(from.entityType,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from.entityType,to);
+  prepareAdjacency(from.entityType,to);
   return UnstructuredMappingAdjacencyIterator(*this, from.entityType, *from, to, 0, skipGhostEntities);
 }
 
@@ -938,7 +1014,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_end(UnstructuredMappingIterator from, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(from.entityType,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from.entityType,to);
+  prepareAdjacency(from.entityType,to);
   return UnstructuredMappingAdjacencyIterator(*this, from.entityType, *from, to, 1, skipGhostEntities);
 }
 
@@ -946,7 +1022,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_begin(UnstructuredMappingAdjacencyIterator from, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(from.adjEntityType,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from.adjEntityType,to);
+  prepareAdjacency(from.adjEntityType,to);
   return UnstructuredMappingAdjacencyIterator(*this, from.adjEntityType, *from, to, 0, skipGhostEntities);
 }
 
@@ -954,7 +1030,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_end(UnstructuredMappingAdjacencyIterator from, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(from.adjEntityType,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from.adjEntityType,to);
+  prepareAdjacency(from.adjEntityType,to);
   return UnstructuredMappingAdjacencyIterator(*this, from.adjEntityType, *from, to, 1, skipGhostEntities);
 }
 
@@ -962,7 +1038,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_begin(IDTuple from, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(from.et,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from.et,to);
+  prepareAdjacency(from.et,to);
   return UnstructuredMappingAdjacencyIterator(*this, from.et, from.e, to, 0, skipGhostEntities);
 }
 
@@ -970,7 +1046,7 @@ inline UnstructuredMappingAdjacencyIterator
 UnstructuredMapping::
 adjacency_end(IDTuple from, EntityTypeEnum to, bool skipGhostEntities) const
 {
-  if ( !connectivityExists(from.et,to) ) ((UnstructuredMapping *)this)->buildConnectivity(from.et,to);
+  prepareAdjacency(from.et,to);
   return UnstructuredMappingAdjacencyIterator(*this, from.et, from.e, to, 1, skipGhostEntities);
 }
 
@@ -23,6 +23,19 @@ namespace GridFunctionNorms
 int getBounds(const realCompositeGridFunction & u, RealArray & uMin, RealArray & uMax, const Range & C=nullRange  );
 int getBounds(const realMappedGridFunction & u, RealArray & uMin, RealArray & uMax, const Range & C=nullRange  );
 
+// Compute the l2 and max norms (and optionally min/max values and the point count) of many components
+// over all grids with one sum and one max reduction
+int getNorms(const realCompositeGridFunction & u, RealArray & l2Norm, RealArray & maxNorm, 
+             const Range & C=nullRange, int maskOption=0, int extra=0,
+             RealArray *uMin=NULL, RealArray *uMax=NULL, int *count=NULL );
+int getNorms(const realMappedGridFunction & u, RealArray & l2Norm, RealArray & maxNorm, 
+             const Range & C=nullRange, int maskOption=0, int extra=0,
+             RealArray *uMin=NULL, RealArray *uMax=NULL, int *count=NULL );
+
+// Compute the dot products SUM u_c*v_c of many components over all grids with one reduction
+int getDotProducts(const realCompositeGridFunction & u, const realCompositeGridFunction & v, RealArray & dot,
+                   const Range & C=nullRange, int maskOption=0, int extra=0, int *count=NULL );
+
 };
 
 